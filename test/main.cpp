@@ -2,6 +2,12 @@
 #include "gtest/gtest.h"
 #include <cstdint>
 #include <array>
+#include <clocale>
+#include <cstdio>
+#include <vector>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 #define EXPECT_ERR(statement, _Err, _line)                                \
     do {                                                                  \
@@ -60,6 +66,43 @@ TEST(num, int)
     EXPECT_THROW(json.parse("-1").as_int().get_u32(),          ujson::ErrBadIntRange);
 }
 
+TEST(num, int_digits)
+{
+    ujson::Json json;
+
+    // Every length from 1 to 19 digits, around each power of 10:
+    int64_t p = 1;
+    for (int k = 1; k <= 18; k++) {
+        p *= 10;
+        for (int64_t v : {p - 1, p, p + 1, -p, -p - 1}) {
+            EXPECT_EQ(json.parse(std::to_string(v).c_str()).as_int().get(), v);
+        }
+    }
+    EXPECT_EQ   (json.parse(" 1234567890123456789").as_int().get(),  1234567890123456789);
+    EXPECT_EQ   (json.parse("-1234567890123456789").as_int().get(), -1234567890123456789);
+
+    // Overflows that wrap around to a valid looking value when computed modulo 2^64:
+    EXPECT_THROW(json.parse(" 18446744073709551616"), ujson::ErrSyntax); // 2^64
+    EXPECT_THROW(json.parse(" 18446744073709551615"), ujson::ErrSyntax); // 2^64 - 1
+    EXPECT_THROW(json.parse("-18446744073709551615"), ujson::ErrSyntax);
+    EXPECT_THROW(json.parse(" 10000000000000000000"), ujson::ErrSyntax); // 20 digits
+    EXPECT_THROW(json.parse(" 99999999999999999999"), ujson::ErrSyntax); // 20 digits
+    EXPECT_THROW(json.parse(" 012345678901234567"),   ujson::ErrSyntax); // a number can't start with 0 if it is followed by another digit
+    EXPECT_THROW(json.parse(" +12345678901234567"),   ujson::ErrSyntax); // '+' can't precede a number
+
+    // A group of 8 digits must stop at the first non-digit, even if more digits follow it:
+    auto& arr = json.parse("[1234,5678,1234567,12345678,9,123456789,1234567812345678,9]").as_arr();
+    ASSERT_EQ(arr.get_len(), 8);
+    EXPECT_EQ(arr.get_i64(0), 1234);
+    EXPECT_EQ(arr.get_i64(1), 5678);
+    EXPECT_EQ(arr.get_i64(2), 1234567);
+    EXPECT_EQ(arr.get_i64(3), 12345678);
+    EXPECT_EQ(arr.get_i64(4), 9);
+    EXPECT_EQ(arr.get_i64(5), 123456789);
+    EXPECT_EQ(arr.get_i64(6), 1234567812345678);
+    EXPECT_EQ(arr.get_i64(7), 9);
+}
+
 TEST(num, hex)
 {
     ujson::Json  json;
@@ -73,6 +116,40 @@ TEST(num, hex)
     EXPECT_THROW(json.parse("0x10000000000000000", 0, ujson::optHex), ujson::ErrSyntax); // doesn't fit in 64 bit
 }
 
+TEST(num, hex_digits)
+{
+    ujson::Json json;
+
+    // Every length from 1 to 16 nibbles, mixed case:
+    const std::string all_digits = "FeDcBa9876543210";
+    for (size_t n = 1; n <= all_digits.size(); n++) {
+        SCOPED_TRACE(n);
+        const std::string digits = all_digits.substr(0, n);
+        const uint64_t v = std::stoull(digits, nullptr, 16);
+        EXPECT_EQ(json.parse(( "0x" + digits).c_str(), 0, ujson::optHex).as_int().get(), static_cast<int64_t>(v));
+        EXPECT_EQ(json.parse(("-0x" + digits).c_str(), 0, ujson::optHex).as_int().get(), static_cast<int64_t>(0 - v));
+    }
+    EXPECT_EQ   (json.parse(" 0x8000000000000000", 0, ujson::optHex).as_int().get(), INT64_MIN); // wraps around
+    EXPECT_THROW(json.parse("0x1FFFFFFFFFFFFFFFF", 0, ujson::optHex), ujson::ErrSyntax); // doesn't fit in 64 bit
+    EXPECT_THROW(json.parse("0x",                  0, ujson::optHex), ujson::ErrSyntax); // no digits
+    EXPECT_THROW(json.parse("0xG",                 0, ujson::optHex), ujson::ErrSyntax); // no digits
+    EXPECT_THROW(json.parse("0x1"), ujson::ErrSyntax); // hex not enabled
+
+    // A group of nibbles must stop at the first non-digit, even if more digits follow it:
+    auto& arr = json.parse("[0x1234567,0x12345678,0x123456789,0x123456789ABCDEF,0xFEDCBA9876543210,0x1,0xA]", 0, ujson::optHex).as_arr();
+    ASSERT_EQ(arr.get_len(), 7);
+    EXPECT_EQ(arr.get_i64(0), 0x1234567);
+    EXPECT_EQ(arr.get_i64(1), 0x12345678);
+    EXPECT_EQ(arr.get_i64(2), 0x123456789);
+    EXPECT_EQ(arr.get_i64(3), 0x123456789ABCDEF);
+    EXPECT_EQ(arr.get_i64(4), static_cast<int64_t>(0xFEDCBA9876543210));
+    EXPECT_EQ(arr.get_i64(5), 0x1);
+    EXPECT_EQ(arr.get_i64(6), 0xA);
+
+    // A 17th nibble right after a full group must not be dropped:
+    EXPECT_THROW(json.parse("[0x1,0x10000000000000000,0x1]", 0, ujson::optHex), ujson::ErrSyntax);
+}
+
 TEST(num, f64)
 {
     ujson::Json      json;
@@ -89,6 +166,58 @@ TEST(num, f64)
     EXPECT_THROW    (json.parse("  1.e3", 0, ujson::optStandard), ujson::ErrSyntax); // empty fractions not allowed by JSON standard
 }
 
+TEST(num, f64_rounding)
+{
+    // Parsed values must be correctly rounded, i.e. bit-exact with the compiler's literals.
+    ujson::Json json;
+    EXPECT_EQ(json.parse("0.1"                        ).as_f64().get(), 0.1);
+    EXPECT_EQ(json.parse("0.30000000000000004"        ).as_f64().get(), 0.30000000000000004);
+    EXPECT_EQ(json.parse("37.774929"                  ).as_f64().get(), 37.774929);
+    EXPECT_EQ(json.parse("-122.419416"                ).as_f64().get(), -122.419416);
+    EXPECT_EQ(json.parse("9007199254740993.0"         ).as_f64().get(), 9007199254740993.0); // halfway, rounds to even
+    EXPECT_EQ(json.parse("7.2057594037927933e16"      ).as_f64().get(), 7.2057594037927933e16);
+    EXPECT_EQ(json.parse("1.7976931348623157e308"     ).as_f64().get(), 1.7976931348623157e308); // DBL_MAX
+    EXPECT_EQ(json.parse("2.2250738585072014e-308"    ).as_f64().get(), 2.2250738585072014e-308); // DBL_MIN
+    EXPECT_EQ(json.parse("-1.234567890123456789012e-5").as_f64().get(), -1.234567890123456789012e-5); // more than 19 digits
+}
+
+TEST(num, f64_locale)
+{
+    // The decimal point must not depend on the current locale, e.g. German uses ','.
+
+    // Restores the previous locale when leaving the test, even on a skip or an exception.
+    struct LocaleGuard {
+        std::string prev;
+        ~LocaleGuard() { std::setlocale(LC_NUMERIC, prev.c_str()); }
+    } guard{std::setlocale(LC_NUMERIC, nullptr)};
+
+    if (!std::setlocale(LC_NUMERIC, "de_DE.UTF-8") && !std::setlocale(LC_NUMERIC, "de-DE")) {
+        GTEST_SKIP() << "German locale is not installed";
+    }
+    ujson::Json json;
+    EXPECT_EQ(json.parse("3.25").as_f64().get(), 3.25);
+}
+
+TEST(num, validated_at_parse)
+{
+    ujson::Json json;
+
+    // The type is known right after parsing, before any value is accessed:
+    auto& arr = json.parse("[10, 1.5, -7, 2e3]").as_arr();
+    EXPECT_EQ(arr.get_element(0).get_type(), ujson::vtInt);
+    EXPECT_EQ(arr.get_element(1).get_type(), ujson::vtF64);
+    EXPECT_EQ(arr.get_element(2).get_type(), ujson::vtInt);
+    EXPECT_EQ(arr.get_element(3).get_type(), ujson::vtF64);
+
+    // Syntax errors in numbers are reported by parse() even if they are never accessed.
+    // Integers out of INT64 range are still ErrSyntax at parse time, see TEST(num, int).
+    EXPECT_THROW(json.parse(R"({"a":1, "b":1e99999999})"),          ujson::ErrSyntax); // number too huge
+    EXPECT_THROW(json.parse(R"({"a":1, "b":01})"),                  ujson::ErrSyntax); // a number can't start with 0 if it is followed by another digit
+    EXPECT_THROW(json.parse(R"({"a":1, "b":1e})"),                  ujson::ErrSyntax); // exponent without digits
+    EXPECT_THROW(json.parse(R"({"a":1, "b":-})"),                   ujson::ErrSyntax); // '-' must be followed by a digit
+    EXPECT_THROW(json.parse(R"({"a":1, "b":1.})", 0, ujson::optStandard), ujson::ErrSyntax); // empty fractions not allowed by JSON standard
+}
+
 TEST(str, plain)
 {
     ujson::Json  json;
@@ -146,6 +275,99 @@ TEST(str, encoding)
     EXPECT_THROW(json.parse("\"\\uD83D\\uC000\""), ujson::ErrSyntax); //  low surrogate not in range (0xDC00 ... 0xDFFF)
 }
 
+TEST(str, long)
+{
+    // Quotes, escapes, control and non-ASCII characters at every position of a long string.
+    ujson::Json json;
+    for (size_t n = 0; n < 150; n++) {
+        SCOPED_TRACE(n);
+        const std::string x(n, 'x');
+        const std::string value = x + "\xF4\x8F\xBF\xBF\x7F~" + x;
+        EXPECT_EQ   (std::string(json.parse(("\"" + value      + "\"").c_str()).as_str().get()), value);
+        EXPECT_EQ   (std::string(json.parse(("\"" + x + "\\n"  + x + "\"").c_str()).as_str().get()), x + "\n" + x);
+        EXPECT_EQ   (std::string(json.parse(("\"" + x + "\\\"" + x + "\"").c_str()).as_str().get()), x + "\"" + x);
+        EXPECT_THROW(json.parse(("\"" + x + "\x1F" + x + "\"").c_str()), ujson::ErrSyntax); // no control characters allowed inside string
+        EXPECT_THROW(json.parse(("\"" + x + "\\"   + x + "\"").c_str()), ujson::ErrSyntax); // bad escape character ('x' or '"' at the end)
+        EXPECT_THROW(json.parse(("\"" + value).c_str()), ujson::ErrSyntax); // no closing quotes
+    }
+}
+
+TEST(str, encoding_runs)
+{
+    ujson::Json json;
+
+    // Runs of consecutive escapes, mixed case hex digits, mixed with plain text:
+    EXPECT_STREQ(json.parse(R"("\u00E9\u00e9\u00E9")"      ).as_str().get(), "\xC3\xA9\xC3\xA9\xC3\xA9");
+    EXPECT_STREQ(json.parse(R"("a\u00E9b\u20ACc")"         ).as_str().get(), "a\xC3\xA9" "b\xE2\x82\xAC" "c");
+    EXPECT_STREQ(json.parse(R"("\uD83D\uDE02\ud83d\ude02")").as_str().get(), "\xF0\x9F\x98\x82\xF0\x9F\x98\x82");
+    EXPECT_STREQ(json.parse(R"("A\uD83D\uDE02B")"          ).as_str().get(), "A\xF0\x9F\x98\x82" "B");
+    EXPECT_STREQ(json.parse(R"("\u00E9\n\u00E9")"          ).as_str().get(), "\xC3\xA9\n\xC3\xA9");
+
+    // A long run of escapes:
+    std::string in = "\"", expected;
+    for (int i = 0; i < 100; i++) {
+        in += R"(\u00E9\uD83D\uDE02)";
+        expected += "\xC3\xA9\xF0\x9F\x98\x82";
+    }
+    in += "\"";
+    EXPECT_EQ(std::string(json.parse(in.c_str()).as_str().get()), expected);
+
+    // Rejection rules must also hold in the middle of a run:
+    EXPECT_THROW(json.parse(R"("\u00E9\u00G9")"      ), ujson::ErrSyntax); // 4 hex digits expected
+    EXPECT_THROW(json.parse(R"("\u00E9\uD83Dx")"     ), ujson::ErrSyntax); // low surrogate not specified
+    EXPECT_THROW(json.parse(R"("\u00E9\uD83D\u00E9")"), ujson::ErrSyntax); //  low surrogate not in range (0xDC00 ... 0xDFFF)
+    EXPECT_THROW(json.parse(R"("\u00E9\uDE02\u00E9")"), ujson::ErrSyntax); // high surrogate not in range (0xD800 ... 0xDBFF)
+}
+
+TEST(str, escaped_names)
+{
+    ujson::Json json;
+    auto& obj = json.parse(R"({"a\"b":1, "c\\d":"e\tf", "plain":"g"})").as_obj();
+
+    // Member names are compared after unescaping:
+    EXPECT_STREQ(obj.get_member_name(0), "a\"b");
+    EXPECT_STREQ(obj.get_member_name(1), "c\\d");
+    EXPECT_EQ   (obj.get_i32("a\"b"), 1);
+    EXPECT_EQ   (obj.get_member_idx("c\\d"), 1);
+    EXPECT_EQ   (obj.get_member_idx("a\\\"b", false), -1); // raw (escaped) text must not match
+
+    // Repeated access returns the same string:
+    const char* s1 = obj.get_str("c\\d");
+    const char* s2 = obj.get_str("c\\d");
+    EXPECT_STREQ(s1, "e\tf");
+    EXPECT_EQ   (s1, s2);
+    EXPECT_EQ   (obj.get_str("plain"), obj.get_str("plain"));
+
+    // Bad escapes are reported at parse time, even if the string is never accessed:
+    EXPECT_THROW(json.parse(R"({"a":1, "b":"\p"})"), ujson::ErrSyntax);
+    EXPECT_THROW(json.parse(R"({"a":1, "\p":2})"),   ujson::ErrSyntax);
+}
+
+TEST(str, utf8)
+{
+    // Valid UTF-8 must pass through unchanged, including the boundaries of each sequence length.
+    const char* const valid[] = {
+        "\xC2\x80",         // U+0080
+        "\xDF\xBF",         // U+07FF
+        "\xE0\xA0\x80",     // U+0800
+        "\xED\x9F\xBF",     // U+D7FF (last before surrogates)
+        "\xEE\x80\x80",     // U+E000 (first after surrogates)
+        "\xEF\xBF\xBF",     // U+FFFF
+        "\xF0\x90\x80\x80", // U+10000
+        "\xF4\x8F\xBF\xBF", // U+10FFFF
+    };
+    ujson::Json json;
+    for (const char* ch : valid) {
+        SCOPED_TRACE(ch);
+        for (size_t n = 0; n < 70; n++) {
+            const std::string value = std::string(n, 'x') + ch;
+            EXPECT_EQ(std::string(json.parse(("\"" + value + "\"").c_str()).as_str().get()), value);
+        }
+        const std::string name = std::string("k") + ch;
+        EXPECT_STREQ(json.parse(("{\"" + name + "\":1}").c_str()).as_obj().get_member_name(0), name.c_str());
+    }
+}
+
 TEST(str, enum)
 {
 
@@ -333,6 +555,91 @@ TEST(obj, duplicates)
     EXPECT_EQ(obj.get_element(1).as_int().get_i32(), 2); // duplicate member can be only accessed by index
 }
 
+// Generates 'n' object members, one per line: "<prefix>0":0, "<prefix>1":1, ...
+static std::string gen_members(const char* prefix, int n)
+{
+    std::string s;
+    for (int i = 0; i < n; i++) {
+        s += "\"" + (prefix + std::to_string(i)) + "\":" + std::to_string(i) + ",\n";
+    }
+    return s;
+}
+
+TEST(obj, large)
+{
+    // Large objects keep member order and resolve every name to its index.
+    const int n = 2000;
+    const std::string s = "{" + gen_members("key", n) + "\"key\":-1}";
+
+    ujson::Json json;
+    auto& obj = json.parse(s.c_str()).as_obj();
+    ASSERT_EQ(obj.get_len(), n + 1);
+    for (int i = 0; i < n; i++) {
+        const std::string name = "key" + std::to_string(i);
+        EXPECT_EQ   (obj.get_member_idx(name.c_str()), i);
+        EXPECT_EQ   (obj.get_i32(name.c_str()), i);
+        EXPECT_STREQ(obj.get_member_name(i), name.c_str());
+    }
+    EXPECT_EQ   (obj.get_member_idx("key"), n); // prefix of all other names
+    EXPECT_EQ   (obj.get_member_idx("key2000", false), -1);
+    EXPECT_EQ   (obj.get_member_idx("ke", false), -1);
+    EXPECT_EQ   (obj.get_member_idx("", false), -1);
+    EXPECT_EQ   (obj.get_member("key00", false), nullptr);
+    EXPECT_THROW(obj.get_i32("absent"), ujson::ErrMemberNotFound);
+}
+
+TEST(obj, duplicates_many)
+{
+    // One member per line, so that the error line points at the duplicate.
+    const int n = 2000;
+    const std::string s = "{\n" + gen_members("m", n); // lines 1 ... n+1
+
+    ujson::Json json;
+    EXPECT_EQ (json.parse((s + R"("m":0})"      ).c_str()).as_obj().get_len(), n + 1); // no duplicates
+    EXPECT_ERR(json.parse((s + R"("m0":0})"     ).c_str()), ujson::ErrSyntax, n + 2); // duplicate of the first member
+    EXPECT_ERR(json.parse((s + R"("m1999":0})"  ).c_str()), ujson::ErrSyntax, n + 2); // duplicate of the previous member
+    EXPECT_ERR(json.parse((s + R"("\u006D5":0})").c_str()), ujson::ErrSyntax, n + 2); // "m5" with an escape
+
+    auto& obj = json.parse((s + "\"m0\":-1}").c_str(), 0, ujson::optStandard).as_obj(); // duplicate member allowed by standard
+    ASSERT_EQ   (obj.get_len(), n + 1);
+    EXPECT_STREQ(obj.get_member_name(n), ""); // duplicate member has no name
+    EXPECT_EQ   (obj.get_i32("m0"), 0);       // first member can be accessed by name
+    EXPECT_EQ   (obj.get_element(n).as_int().get_i32(), -1);
+}
+
+TEST(obj, records)
+{
+    // Arrays of records with the same member names, but not always in the same slots.
+    const char in_str[] =
+    R"([
+        { "type": "button", "name": "OK"     },
+        { "type": "button", "name": "Cancel" },
+        { "name": "Help",   "type": "link"   },
+        { "id": 7, "type": "label", "name": "Title" },
+        { "type": "spacer" },
+        { "name": "type",   "type": "name"   },
+    ])";
+    const char* const types[] = {"button", "button", "link", "label", "spacer", "name"};
+    const char* const names[] = {"OK", "Cancel", "Help", "Title", nullptr, "type"};
+
+    ujson::Json json;
+    const ujson::Arr& widgets = json.parse(in_str).as_arr();
+    ASSERT_EQ(widgets.get_len(), 6);
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t i = 0; i < widgets.get_len(); i++) {
+            SCOPED_TRACE(i);
+            const ujson::Obj& item = widgets.get_obj(i);
+            EXPECT_STREQ(item.get_str("type"), types[i]);
+            if (names[i]) {
+                EXPECT_STREQ(item.get_str("name"), names[i]);
+            }
+            else {
+                EXPECT_EQ(item.get_member("name", false), nullptr);
+            }
+        }
+    }
+}
+
 TEST(obj, get_bool)
 {
     ujson::Json json;
@@ -590,6 +897,65 @@ TEST(val, get_line)
     EXPECT_EQ(obj.get_member("foo")->get_line(), 11);
 }
 
+TEST(val, get_line_indented)
+{
+    // Long runs of whitespace and comments must not break line counting.
+    const std::string spaces(100, ' ');
+    const std::string tabs(50, '\t');
+    const std::string comment = "// " + std::string(200, '/') + " \" { [ ,";
+
+    std::string s;
+    s += "{\n";                                       // 01
+    s += spaces + comment + "\n";                     // 02
+    s += spaces + "\"num\" : 1, " + comment + "\n";   // 03
+    s += "\n" + spaces + "\n" + tabs + "\n";          // 04 ... 06
+    s += tabs + "\"arr\" : [ " + comment + "\n";      // 07
+    s += spaces + tabs + "2\n";                       // 08
+    s += spaces + "]\n";                              // 09
+    s += "}" + spaces;                                // 10
+
+    ujson::Json json;
+    const uint32_t options = ujson::optDefault | ujson::optLineCommentC;
+    const ujson::Obj& root = json.parse(s.c_str(), 0, options).as_obj();
+    auto& arr = root.get_arr("arr");
+
+    EXPECT_EQ(root.get_line(), 1);
+    EXPECT_EQ(root.get_member("num")->get_line(), 3);
+    EXPECT_EQ(arr.get_line(), 7);
+    EXPECT_EQ(arr.get_element(0).get_line(), 8);
+
+    std::string bad;
+    bad += "{\n";                                     // 01
+    bad += spaces + comment + "\n";                   // 02
+    bad += tabs + comment + "\n";                     // 03
+    bad += spaces + "\"bar\" 2\n";                    // 04 (no ':')
+    bad += "}";
+    EXPECT_ERR(json.parse(bad.c_str(), 0, options), ujson::ErrSyntax, 4);
+}
+
+TEST(val, get_line_many)
+{
+    // One element per line, each with escaped newlines which must not be counted.
+    std::string s = "[\n";                            // 0001
+    for (int i = 0; i < 1000; i++) {
+        s += "\"a\\nb\\n\",\n";                       // 0002 ... 1001
+    }
+    s += "0\n]";                                      // 1002
+
+    ujson::Json json;
+    auto& arr = json.parse(s.c_str()).as_arr();
+    ASSERT_EQ(arr.get_len(), 1001);
+    EXPECT_EQ(arr.get_line(), 1);
+    for (size_t i = 0; i < arr.get_len(); i++) {
+        EXPECT_EQ(arr.get_element(i).get_line(), static_cast<int32_t>(i + 2));
+    }
+
+    // Errors far from the start of the text:
+    const std::string nl(500, '\n');
+    EXPECT_ERR(json.parse((nl + "[1, 2, x]").c_str()), ujson::ErrSyntax, 501);
+    EXPECT_ERR(json.parse((nl + "[1,\n2,").c_str()),   ujson::ErrSyntax, 502); // error at the end of the text
+}
+
 TEST(val, reject_unknown_member)
 {
     const char in_str[] =
@@ -681,6 +1047,216 @@ TEST(json, nested_level)
     }
 }
 
+TEST(json, reuse)
+{
+    // The same Json instance parses large, small and invalid texts in turn.
+    std::string big = "[";
+    for (int i = 0; i < 10000; i++) {
+        big += "{\"id\":" + std::to_string(i) + ",\"name\":\"item " + std::to_string(i) + "\"},";
+    }
+    big += "null]";
+
+    ujson::Json json;
+    for (int round = 0; round < 3; round++) {
+        SCOPED_TRACE(round);
+        auto& arr = json.parse(big.c_str()).as_arr();
+        ASSERT_EQ(arr.get_len(), 10001);
+        EXPECT_EQ   (arr.get_obj(9999).get_i32("id"), 9999);
+        EXPECT_STREQ(arr.get_obj(9999).get_str("name"), "item 9999");
+
+        EXPECT_EQ   (json.parse("42").as_int().get(), 42);
+        EXPECT_THROW(json.parse(R"(["a","b")"), ujson::ErrSyntax);
+        EXPECT_STREQ(json.parse(R"(["c","d"])").as_arr().get_str(1), "d");
+    }
+}
+
+TEST(json, all_types)
+{
+    // Every value type with full range payloads, one record per line, nested in arrays and objects.
+    std::string s = "[\n";
+    for (int i = 0; i < 1000; i++) {
+        s += R"({"n":null,"b":true,"min":-9223372036854775808,"max":9223372036854775807,)"
+             R"("f":-1.5e300,"s":"str","a":[[],{}],"o":{"x":[false]}},)" "\n";
+    }
+    s += "0]";
+
+    ujson::Json json;
+    auto& arr = json.parse(s.c_str()).as_arr();
+    ASSERT_EQ(arr.get_len(), 1001);
+    for (size_t i = 0; i < 1000; i++) {
+        auto& obj = arr.get_obj(i);
+        ASSERT_EQ(obj.get_len(), 8);
+        EXPECT_EQ       (obj.get_line(), static_cast<int32_t>(i + 2));
+        EXPECT_EQ       (obj.get_member("n")->get_type(), ujson::vtNull);
+        EXPECT_EQ       (obj.get_bool("b"), true);
+        EXPECT_EQ       (obj.get_i64("min"), INT64_MIN);
+        EXPECT_EQ       (obj.get_i64("max"), INT64_MAX);
+        EXPECT_DOUBLE_EQ(obj.get_f64("f"), -1.5e300);
+        EXPECT_STREQ    (obj.get_str("s"), "str");
+        EXPECT_EQ       (obj.get_arr("a").get_arr(0).get_len(), 0);
+        EXPECT_EQ       (obj.get_arr("a").get_obj(1).get_len(), 0);
+        EXPECT_EQ       (obj.get_obj("o").get_arr("x").get_bool(0), false);
+    }
+    EXPECT_EQ(arr.get_element(1000).as_int().get(), 0);
+}
+
+TEST(json, block_boundaries)
+{
+    // The same document shifted by 0 ... 129 leading spaces, so that every structural
+    // character, quote and escape sequence lands on every position of a 64 byte block.
+    const char in_str[] = R"({"a":"x\"y\\","b":[1,{"c":":,[]{}"}],"d":"\\\\\"\\"})";
+
+    ujson::Json json;
+    for (size_t pad = 0; pad < 130; pad++) {
+        SCOPED_TRACE(pad);
+        const std::string s = std::string(pad, ' ') + in_str;
+        const ujson::Obj& root = json.parse(s.c_str()).as_obj();
+        ASSERT_EQ   (root.get_len(), 3);
+        EXPECT_STREQ(root.get_str("a"), "x\"y\\");
+        EXPECT_STREQ(root.get_str("d"), "\\\\\"\\");
+        const ujson::Arr& b = root.get_arr("b");
+        ASSERT_EQ   (b.get_len(), 2);
+        EXPECT_EQ   (b.get_i32(0), 1);
+        EXPECT_STREQ(b.get_obj(1).get_str("c"), ":,[]{}"); // structural characters inside a string
+    }
+}
+
+// Benchmarks are disabled by default. Run them with:
+//
+//    ujson-test --gtest_also_run_disabled_tests --gtest_filter=bench.*
+//
+TEST(bench, DISABLED_obj_duplicates)
+{
+    // 100000 members, every one checked for a duplicate name at parse time.
+    // The text is built once and parsed repeatedly, so that parsing dominates the time.
+    const int n = 100000;
+    const std::string s    = "{" + gen_members("m", n) + "}";
+    const std::string dupl = "{" + gen_members("m", n) + "\"m0\":0}";
+
+    ujson::Json json;
+    for (int round = 0; round < 10; round++) {
+        EXPECT_EQ   (json.parse(s.c_str()).as_obj().get_len(), n);
+        EXPECT_THROW(json.parse(dupl.c_str()), ujson::ErrSyntax);
+    }
+}
+
+TEST(bench, DISABLED_obj_lookup)
+{
+    // 20000 members, each looked up by name 100 times, so that lookups dominate the time.
+    const int n = 20000;
+    const std::string s = "{" + gen_members("key", n) + "}";
+    std::vector<std::string> names;
+    for (int i = 0; i < n; i++) {
+        names.push_back("key" + std::to_string(i));
+    }
+
+    ujson::Json json;
+    auto& obj = json.parse(s.c_str()).as_obj();
+    ASSERT_EQ(obj.get_len(), n);
+    int64_t sum = 0;
+    for (int round = 0; round < 100; round++) {
+        for (const std::string& name : names) {
+            sum += obj.get_i32(name.c_str());
+        }
+    }
+    EXPECT_EQ(sum, 100 * (static_cast<int64_t>(n) * (n - 1) / 2));
+}
+
+TEST(bench, DISABLED_indented)
+{
+    // 20000 elements nested 8 levels deep, indented by 4 spaces per level and commented on every line.
+    const int n = 20000;
+    const int depth = 8;
+    std::string s = "[\n";
+    for (int i = 0; i < n; i++) {
+        s += "    // element " + std::to_string(i) + ", nested " + std::to_string(depth) + " levels deep\n";
+        for (int d = 1; d <= depth; d++) {
+            s += std::string(4 * d, ' ') + "[ // level " + std::to_string(d) + "\n";
+        }
+        s += std::string(4 * (depth + 1), ' ') + std::to_string(i) + "\n";
+        for (int d = depth; d >= 1; d--) {
+            s += std::string(4 * d, ' ') + (d > 1 ? "]" : "],") + "\n";
+        }
+    }
+    s += "]";
+
+    ujson::Json json;
+    const uint32_t options = ujson::optDefault | ujson::optLineCommentC;
+    for (int round = 0; round < 10; round++) {
+        EXPECT_EQ(json.parse(s.c_str(), 0, options).as_arr().get_len(), n);
+    }
+}
+
+TEST(bench, DISABLED_hex)
+{
+    // 500000 literals of 16 nibbles each.
+    const int n = 500000;
+    std::string s = "[";
+    uint64_t v = 0;
+    char buf[24];
+    for (int i = 0; i < n; i++) {
+        v += 0x9E3779B97F4A7C15;
+        snprintf(buf, sizeof(buf), "0x%016llX,", static_cast<unsigned long long>(v));
+        s += buf;
+    }
+    s.back() = ']';
+
+    ujson::Json json;
+    for (int round = 0; round < 10; round++) {
+        auto& arr = json.parse(s.c_str(), 0, ujson::optHex).as_arr();
+        ASSERT_EQ(arr.get_len(), n);
+        EXPECT_EQ(arr.get_i64(n - 1), static_cast<int64_t>(v));
+    }
+}
+
+#if defined(__linux__) && SIZE_MAX > UINT32_MAX
+TEST(bench, DISABLED_over_4gb)
+{
+    // A text of more than 4 GB, made of three 16 MB chunks of a temporary file. The filler chunk
+    // is mapped over and over again, so the test needs only 48 MB of memory or disk.
+    const size_t chunk   = 16 << 20;
+    const size_t fillers = (size_t(4) << 30) / chunk + 1;
+    const size_t total   = (fillers + 2) * chunk;
+
+    std::string head(chunk, ' '), filler(chunk, ' '), tail(chunk, ' ');
+    head.replace(0, 3, "[0,");
+    head.back()   = '\n'; // line 1
+    filler.back() = '\n'; // lines 2 ... fillers+1
+    const char end[] = "1,\"end\"]"; // line fillers+2, past the 4 GB mark, followed by '\0'
+    tail.replace(chunk - sizeof(end), sizeof(end), end, sizeof(end));
+
+    FILE* f = tmpfile();
+    ASSERT_NE(f, nullptr);
+    for (const std::string* s : {&head, &filler, &tail}) {
+        ASSERT_EQ(fwrite(s->data(), 1, chunk, f), chunk);
+    }
+    ASSERT_EQ(fflush(f), 0);
+
+    // Unmaps the text and closes the file when leaving the test.
+    struct MapGuard {
+        char*  text;
+        size_t size;
+        FILE*  file;
+        ~MapGuard() { munmap(text, size); fclose(file); }
+    } guard{static_cast<char*>(mmap(nullptr, total, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)), total, f};
+    ASSERT_NE(guard.text, MAP_FAILED);
+
+    const int fd = fileno(f);
+    for (size_t i = 0; i < fillers + 2; i++) {
+        const off_t offset = static_cast<off_t>(i == 0 ? 0 : i <= fillers ? chunk : 2 * chunk);
+        ASSERT_NE(mmap(guard.text + i * chunk, chunk, PROT_READ, MAP_SHARED | MAP_FIXED, fd, offset), MAP_FAILED);
+    }
+
+    ujson::Json json;
+    auto& arr = json.parse(guard.text, total - 1).as_arr();
+    ASSERT_EQ   (arr.get_len(), 3);
+    EXPECT_EQ   (arr.get_i32(0), 0);
+    EXPECT_EQ   (arr.get_i32(1), 1);
+    EXPECT_STREQ(arr.get_str(2), "end");
+    EXPECT_EQ   (arr.get_element(2).get_line(), static_cast<int32_t>(fillers + 2));
+}
+#endif
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     int errCode = RUN_ALL_TESTS();